@@ -5,22 +5,57 @@
 #include <FS.h>
 #include <wifi_secrets.h>
 
-// Pin-Konfiguration
-const int sensor10Pin = D1;          // 10 % Füllstand
-const int sensor50Pin = D2;          // 50 % Füllstand
-const int sensor80Pin = D3;          // 80 % Füllstand
-const int ledPin = D4;               // Status-LED
-const int sensorCommonPin = D5;      // Der gemeinsame Empfangspin
-const int pumpPin = D7;              // Schaltet Pumpe (Relais oder MOSFET)
-
-// Debug-Mode
-const bool DEBUG_MODE = true; // auf false setzen für normalen Betrieb
+// ========== Laufzeit-Konfiguration ==========
+// Binärer Datensatz in LittleFS (/config.bin). Neue Felder nur VOR crc anhängen und
+// CONFIG_VERSION erhöhen - ältere (kürzere) Datensätze werden dann beim Laden migriert.
+const uint32_t CONFIG_MAGIC = 0x57534346; // "WSCF"
+const uint16_t CONFIG_VERSION = 1;
+const char* CONFIG_PATH = "/config.bin";
+const char* CONFIG_TMP_PATH = "/config.tmp";
+
+struct RuntimeConfig {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;                 // Länge des Datensatzes inkl. crc
+  uint32_t intervalDefault;      // ms, Standard-Messintervall
+  uint32_t intervalFast;         // ms, bei 80 % oder im Debug-Mode
+  uint32_t intervalLong;         // ms, nach Pumpenstopp (nur Normalbetrieb)
+  uint32_t manualPumpMs;         // Laufzeit der manuellen Pumpe
+  uint16_t voteSpacingMs;        // Abstand zwischen den Einzelmessungen
+  uint8_t  voteSamples;          // Anzahl Einzelmessungen pro Sensor
+  uint8_t  voteHits;             // davon mindestens "berührt"
+  uint8_t  stableLimit;          // wie viele Zyklen gleich sein müssen
+  uint8_t  debugMode;            // 1 = Debug-Mode
+  uint8_t  pinSensor10;          // 10 % Füllstand
+  uint8_t  pinSensor50;          // 50 % Füllstand
+  uint8_t  pinSensor80;          // 80 % Füllstand
+  uint8_t  pinLed;               // Status-LED
+  uint8_t  pinCommon;            // Der gemeinsame Empfangspin
+  uint8_t  pinPump;              // Schaltet Pumpe (Relais oder MOSFET)
+  uint32_t crc;                  // CRC32 über alle Bytes davor
+};
+static_assert(offsetof(RuntimeConfig, crc) + sizeof(uint32_t) == sizeof(RuntimeConfig),
+              "crc muss das letzte Feld ohne Padding sein");
+const size_t CONFIG_HEADER_SIZE = offsetof(RuntimeConfig, intervalDefault);
+
+// Doppelpuffer: cfg() liefert immer einen vollständig geprüften Datensatz,
+// Änderungen werden im inaktiven Slot aufgebaut und erst danach umgeschaltet.
+RuntimeConfig configSlots[2];
+uint8_t activeConfigSlot = 0;
+unsigned long configLoadMicros = 0;
+
+inline const RuntimeConfig& cfg() { return configSlots[activeConfigSlot]; }
+
+// Zulässige Pins (NodeMCU-Bezeichnung)
+const uint8_t CONFIG_PINS[] = {D0, D1, D2, D3, D4, D5, D6, D7, D8};
+const char* CONFIG_PIN_NAMES[] = {"D0", "D1", "D2", "D3", "D4", "D5", "D6", "D7", "D8"};
+const int CONFIG_PIN_COUNT = sizeof(CONFIG_PINS) / sizeof(CONFIG_PINS[0]);
+
+// Obergrenze für die blockierende Dauer einer Sensorabfrage (Standard: 3 x 4 x 500 ms)
+const unsigned long MAX_SCAN_MS = 6000;
 
 // Zeitsteuerung
-unsigned long sensorCheckInterval = 3000; // Standard: 3 Sekunden
-const unsigned long sensorCheckIntervalDefault = 3000;
-const unsigned long sensorCheckIntervalFast = 1000;
-const unsigned long sensorCheckIntervalLong = 60000; // 60 Sekunden
+unsigned long sensorCheckInterval = 3000; // wird in setup() aus der Konfiguration gesetzt
 
 // Zustandsvariablen
 bool flag10 = false;
@@ -33,6 +68,7 @@ unsigned long lastSensorCheck = 0;
 bool isPumping = false;
 bool manualPumpActive = false;
 unsigned long manualPumpOffTime = 0;
+unsigned long manualPumpRunMs = 0; // Dauer des laufenden manuellen Starts (Konfiguration kann sich inzwischen ändern)
 
 // LED-Zustand
 bool ledState = false;
@@ -41,15 +77,26 @@ unsigned long lastLedToggle = 0;
 // Debug-Zähler
 int pumpCycles = 0;
 
+// Zustands-Generation: wird bei jeder Zustandsänderung erhöht (Cache-Schlüssel/ETag der Statusseite)
+uint32_t stateGeneration = 0;
+
+// Gerenderte Statusseite, gültig solange pageCacheGen == stateGeneration
+String pageCache;
+uint32_t pageCacheGen = 0;
+bool pageCacheValid = false;
+const size_t PAGE_CACHE_RESERVE = 6144;
+
 // Neue Hilfsvariablen:
 int stable10 = 0, stable50 = 0, stable80 = 0;
-const int stableLimit = 2; // wie viele Zyklen gleich sein müssen
 
 // Funktion vorab deklarieren
 void flashLED(int times);
 void checkAllWaterLevels();
 void pumpControl();
 void handleRoot();
+void bumpStateGeneration();
+void handleConfigGet();
+void handleConfigPost();
 
 // Wifi Konfiguration
 const char* ssidAP = "Wasserstandssensoren";
@@ -78,6 +125,13 @@ void logMessage(const String& msg) {
   }
   logEntries[0] = entry;
   if (logCount < MAX_LOGS) logCount++;
+  bumpStateGeneration();
+}
+
+// Markiert den gerenderten Zustand als geändert -> Statusseite wird beim nächsten Abruf neu gerendert.
+// logMessage() ruft das selbst auf; Zustandsänderungen mit Log-Eintrag brauchen keinen eigenen Aufruf.
+void bumpStateGeneration() {
+  stateGeneration++;
 }
 
 // Gibt das Log als HTML-String zurück (neueste oben)
@@ -89,20 +143,236 @@ String getLogHtml() {
   return html;
 }
 
+// ========== Konfiguration laden/speichern ==========
+uint32_t configCrc(const void* data, size_t len) {
+  const uint8_t* p = (const uint8_t*)data;
+  uint32_t crc = 0xFFFFFFFF;
+  while (len--) {
+    crc ^= *p++;
+    for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+void setConfigDefaults(RuntimeConfig& c) {
+  memset(&c, 0, sizeof(c));
+  c.magic = CONFIG_MAGIC;
+  c.version = CONFIG_VERSION;
+  c.size = sizeof(RuntimeConfig);
+  c.intervalDefault = 3000;
+  c.intervalFast = 1000;
+  c.intervalLong = 60000;
+  c.manualPumpMs = 10000;
+  c.voteSpacingMs = 500;
+  c.voteSamples = 4;
+  c.voteHits = 3;
+  c.stableLimit = 2;
+  c.debugMode = 1;
+  c.pinSensor10 = D1;
+  c.pinSensor50 = D2;
+  c.pinSensor80 = D3;
+  c.pinLed = D4;
+  c.pinCommon = D5;
+  c.pinPump = D7;
+}
+
+int configPinIndex(uint8_t pin) {
+  for (int i = 0; i < CONFIG_PIN_COUNT; i++) {
+    if (CONFIG_PINS[i] == pin) return i;
+  }
+  return -1;
+}
+
+// Prüft Wertebereiche und Pinbelegung. Bei Fehler steht der Grund in error.
+bool validateConfig(const RuntimeConfig& c, String& error) {
+  if (c.intervalFast < 200 || c.intervalFast > 600000) { error = "Schnelles Intervall: 200 - 600000 ms"; return false; }
+  if (c.intervalDefault < 200 || c.intervalDefault > 3600000) { error = "Standard-Intervall: 200 - 3600000 ms"; return false; }
+  if (c.intervalLong < 1000 || c.intervalLong > 86400000) { error = "Langes Intervall: 1000 - 86400000 ms"; return false; }
+  if (c.manualPumpMs < 1000 || c.manualPumpMs > 600000) { error = "Manuelle Pumpdauer: 1000 - 600000 ms"; return false; }
+  if (c.voteSpacingMs > 2000) { error = "Messabstand: 0 - 2000 ms"; return false; }
+  if (c.voteSamples < 1 || c.voteSamples > 10) { error = "Messungen pro Sensor: 1 - 10"; return false; }
+  if (c.voteHits < 1 || c.voteHits > c.voteSamples) { error = "Treffer: 1 - Anzahl Messungen"; return false; }
+  // checkAllWaterLevels() blockiert für 3 Sensoren x Messungen x Abstand, in der Zeit ruht der Webserver
+  if (3UL * c.voteSamples * c.voteSpacingMs > MAX_SCAN_MS) {
+    error = "3 x Messungen x Abstand darf " + String(MAX_SCAN_MS) + " ms nicht überschreiten";
+    return false;
+  }
+  if (c.stableLimit < 1 || c.stableLimit > 20) { error = "Stabile Zyklen: 1 - 20"; return false; }
+  if (c.debugMode > 1) { error = "Debug-Mode: 0 oder 1"; return false; }
+
+  const uint8_t pins[] = {c.pinSensor10, c.pinSensor50, c.pinSensor80, c.pinLed, c.pinCommon, c.pinPump};
+  for (size_t i = 0; i < sizeof(pins); i++) {
+    if (configPinIndex(pins[i]) < 0) { error = "Ungültiger Pin"; return false; }
+    // updateLED() schreibt LED_BUILTIN unabhängig von der Konfiguration
+    if (pins[i] == LED_BUILTIN && pins[i] != c.pinLed) { error = "D4 (LED_BUILTIN) nur als Status-LED"; return false; }
+    for (size_t j = i + 1; j < sizeof(pins); j++) {
+      if (pins[i] == pins[j]) { error = "Pins doppelt belegt"; return false; }
+    }
+  }
+  // Common-Pin braucht einen funktionierenden internen Pull-up: D0 hat keinen, D8 hat einen externen Pull-down
+  if (c.pinCommon != D1 && c.pinCommon != D2 && c.pinCommon != D5 && c.pinCommon != D6 && c.pinCommon != D7) {
+    error = "Sensor Common: nur D1, D2, D5, D6 oder D7";
+    return false;
+  }
+  // Boot-Pins sind für die Pumpe tabu: D0 und D3 liegen beim Start auf HIGH (Pumpe würde kurz laufen),
+  // D8 muss beim Start LOW bleiben, sonst bootet der ESP8266 nicht
+  if (c.pinPump == D0 || c.pinPump == D3) {
+    error = "Pumpe: D0 und D3 nicht erlaubt (beim Start HIGH)";
+    return false;
+  }
+  if (c.pinPump == D8) {
+    error = "Pumpe: D8 nicht erlaubt (muss beim Start LOW sein)";
+    return false;
+  }
+  return true;
+}
+
+// Schreibt erst in eine temporäre Datei und benennt sie dann um,
+// damit ein Stromausfall nie einen halb geschriebenen Datensatz hinterlässt.
+bool saveConfig(RuntimeConfig& c) {
+  c.magic = CONFIG_MAGIC;
+  c.version = CONFIG_VERSION;
+  c.size = sizeof(RuntimeConfig);
+  c.crc = configCrc(&c, offsetof(RuntimeConfig, crc));
+
+  File f = LittleFS.open(CONFIG_TMP_PATH, "w");
+  if (!f) return false;
+  size_t written = f.write((const uint8_t*)&c, sizeof(c));
+  f.close();
+  if (written != sizeof(c)) {
+    LittleFS.remove(CONFIG_TMP_PATH);
+    return false;
+  }
+  return LittleFS.rename(CONFIG_TMP_PATH, CONFIG_PATH);
+}
+
+// Lädt den Datensatz mit einem einzigen Lesezugriff. Fehlt er oder ist er ungültig,
+// bleiben die Defaults stehen. status beschreibt das Ergebnis für das Log.
+bool loadConfig(RuntimeConfig& out, String& status) {
+  setConfigDefaults(out);
+
+  File f = LittleFS.open(CONFIG_PATH, "r");
+  if (!f) {
+    status = "keine Datei, Defaults";
+    return false;
+  }
+  RuntimeConfig raw;
+  size_t n = f.read((uint8_t*)&raw, sizeof(raw));
+  bool tooLong = f.available() > 0;
+  f.close();
+
+  if (tooLong || n < CONFIG_HEADER_SIZE + sizeof(uint32_t) || raw.magic != CONFIG_MAGIC || raw.size != n) {
+    status = "ungültiger Datensatz, Defaults";
+    return false;
+  }
+  uint32_t storedCrc;
+  memcpy(&storedCrc, (const uint8_t*)&raw + n - sizeof(uint32_t), sizeof(uint32_t));
+  if (configCrc(&raw, n - sizeof(uint32_t)) != storedCrc) {
+    status = "CRC-Fehler, Defaults";
+    return false;
+  }
+  if (raw.version == 0 || raw.version > CONFIG_VERSION) {
+    status = "unbekannte Version " + String(raw.version) + ", Defaults";
+    return false;
+  }
+  // Nur ältere Versionen dürfen kürzer sein
+  if (raw.version == CONFIG_VERSION && n != sizeof(RuntimeConfig)) {
+    status = "falsche Länge für Version " + String(raw.version) + ", Defaults";
+    return false;
+  }
+
+  // Migration: Felder werden nur angehängt, ältere Datensätze sind also ein Präfix
+  // des aktuellen Layouts. Fehlende Felder behalten ihre Defaults.
+  RuntimeConfig loaded = out;
+  memcpy((uint8_t*)&loaded + CONFIG_HEADER_SIZE, (const uint8_t*)&raw + CONFIG_HEADER_SIZE,
+         n - sizeof(uint32_t) - CONFIG_HEADER_SIZE);
+
+  String error;
+  if (!validateConfig(loaded, error)) {
+    status = "Werte ungültig (" + error + "), Defaults";
+    return false;
+  }
+  out = loaded;
+
+  if (raw.version < CONFIG_VERSION) {
+    status = "migriert von Version " + String(raw.version);
+    saveConfig(out);
+  } else {
+    status = "Version " + String(raw.version);
+  }
+  return true;
+}
+
+// Überträgt eine neu aktivierte Konfiguration auf Pins und Intervalle
+void applyConfig(const RuntimeConfig& prev, const RuntimeConfig& next) {
+  // Erst alte Ausgänge freigeben, dann neue setzen (Pins dürfen die Rolle tauschen)
+  if (prev.pinPump != next.pinPump) {
+    digitalWrite(prev.pinPump, LOW);
+    pinMode(prev.pinPump, INPUT);
+  }
+  if (prev.pinLed != next.pinLed) pinMode(prev.pinLed, INPUT);
+  if (prev.pinCommon != next.pinCommon) pinMode(prev.pinCommon, INPUT);
+
+  pinMode(next.pinPump, OUTPUT);
+  digitalWrite(next.pinPump, isPumping ? HIGH : LOW);
+  pinMode(next.pinLed, OUTPUT);
+  pinMode(next.pinCommon, INPUT_PULLUP);
+
+  stable10 = stable50 = stable80 = 0;
+  if (next.debugMode || flag80) {
+    sensorCheckInterval = next.intervalFast;
+  } else {
+    sensorCheckInterval = next.intervalDefault;
+  }
+}
+
+// Baut die neue Konfiguration im inaktiven Slot auf und schaltet erst um,
+// wenn sie geprüft und gespeichert ist.
+bool updateConfig(const RuntimeConfig& candidate, String& error) {
+  uint8_t staging = activeConfigSlot ^ 1;
+  configSlots[staging] = candidate;
+  if (!validateConfig(configSlots[staging], error)) return false;
+  if (!saveConfig(configSlots[staging])) {
+    error = "Speichern in LittleFS fehlgeschlagen";
+    return false;
+  }
+  uint8_t previous = activeConfigSlot;
+  activeConfigSlot = staging;
+  applyConfig(configSlots[previous], cfg());
+  bumpStateGeneration();
+  return true;
+}
+
 // ========== Setup ==========
 void setup() {
   Serial.begin(115200);
-  
-  pinMode(pumpPin, OUTPUT);
-  pinMode(ledPin, OUTPUT);
+
+  // LittleFS zuerst, damit die Pinbelegung aus der Konfiguration kommt
+  bool fsMounted = LittleFS.begin();
+  String configStatus;
+  unsigned long configStart = micros();
+  if (fsMounted) {
+    loadConfig(configSlots[activeConfigSlot], configStatus);
+  } else {
+    setConfigDefaults(configSlots[activeConfigSlot]);
+    configStatus = "kein Dateisystem, Defaults";
+  }
+  configLoadMicros = micros() - configStart;
+
+  pinMode(cfg().pinPump, OUTPUT);
+  pinMode(cfg().pinLed, OUTPUT);
   delay(2000);
 
+  // Zufälliger Startwert, damit ein ETag aus der Zeit vor einem Neustart nicht zufällig wieder passt
+  stateGeneration = ESP.random();
+  pageCache.reserve(PAGE_CACHE_RESERVE);
+
   Serial.println();
   Serial.println("Starte Wasserstandssensoren und Pumpensteuerung...");
   Serial.println("LittleFS initialisieren...");
 
   Serial.println("Starte LittleFS-Test...");
-  if (!LittleFS.begin()) {
+  if (!fsMounted) {
     Serial.println("LittleFS mount failed!");
   } else {
     Serial.println("LittleFS mount OK!");
@@ -113,14 +383,15 @@ void setup() {
     }
     Serial.println("Directory-Listing abgeschlossen.");
   }
+  logMessage("Konfiguration geladen in " + String(configLoadMicros) + " us (" + configStatus + ")");
 
   flashLED(4); // LED blinkt 4x beim Start
   Serial.println();
   Serial.println("Wasserstandssensoren und Pumpensteuerung gestartet");
-  pinMode(sensorCommonPin, INPUT_PULLUP); // Empfangspin
+  pinMode(cfg().pinCommon, INPUT_PULLUP); // Empfangspin
 
-  digitalWrite(pumpPin, LOW);
-  digitalWrite(ledPin, LOW); 
+  digitalWrite(cfg().pinPump, LOW);
+  digitalWrite(cfg().pinLed, LOW); 
   delay(1000); // 1 Sekunde warten, um den Serial Monitor zu öffnen
 
   // WLAN-Verbindung herstellen
@@ -141,14 +412,20 @@ void setup() {
   server.on("/", handleRoot);
   server.on("/pump_on", []() {
     if (!manualPumpActive) {
-      digitalWrite(pumpPin, HIGH);
+      digitalWrite(cfg().pinPump, HIGH);
       isPumping = true; // Damit der Status auf AN wechselt
       manualPumpActive = true;
-      manualPumpOffTime = millis() + 10000; // 10 Sekunden
-      logMessage("Pumpe manuell für 10 Sekunden gestartet");
+      manualPumpRunMs = cfg().manualPumpMs;
+      manualPumpOffTime = millis() + manualPumpRunMs;
+      logMessage("Pumpe manuell für " + String(manualPumpRunMs / 1000.0, 1) + " Sekunden gestartet");
     }
     server.send(200, "text/plain", "OK");
   });
+  server.on("/config", HTTP_GET, handleConfigGet);
+  server.on("/config", HTTP_POST, handleConfigPost);
+  // If-None-Match wird für die ETag-Prüfung der Statusseite benötigt
+  const char* headerKeys[] = {"If-None-Match"};
+  server.collectHeaders(headerKeys, 1);
   server.begin();
   Serial.println("Webserver gestartet");
   Serial.print("erreichbar unter: http://");
@@ -156,11 +433,11 @@ void setup() {
   Serial.println();
 
   // Debug-Mode: Zyklus auf 1 Sekunde setzen
-  if (DEBUG_MODE) {
-    sensorCheckInterval = sensorCheckIntervalFast;
-    Serial.println("DEBUG_MODE aktiv: Sensorzyklus = 1 Sekunde");
+  if (cfg().debugMode) {
+    sensorCheckInterval = cfg().intervalFast;
+    Serial.printf("DEBUG_MODE aktiv: Sensorzyklus = %lu ms\n", sensorCheckInterval);
   } else {
-    sensorCheckInterval = sensorCheckIntervalDefault;
+    sensorCheckInterval = cfg().intervalDefault;
   }
 }
 
@@ -176,30 +453,32 @@ bool isTouched(int testPin, int commonPin) {
   return touched;
 }
 
-// Mehrfachmessung für stabile Sensorwerte (5 Messungen, 500ms Abstand, 4 von 5 müssen stimmen)
+// Mehrfachmessung für stabile Sensorwerte (Standard: 4 Messungen, 500ms Abstand, 3 von 4 müssen stimmen)
 bool isTouchedStable(int testPin, int commonPin) {
+  const RuntimeConfig& c = cfg();
   int hits = 0;
-  for (int i = 0; i < 4; i++) {
+  for (int i = 0; i < c.voteSamples; i++) {
     if (isTouched(testPin, commonPin)) hits++;
-    delay(500); // jetzt 500ms Abstand zwischen den Messungen
+    delay(c.voteSpacingMs);
   }
-  return hits >= 3;
+  return hits >= c.voteHits;
 }
 
 void checkAllWaterLevels() {
-  // Sensoren nacheinander mit 5-fach-Messung abfragen
-  bool newFlag10 = isTouchedStable(sensor10Pin, sensorCommonPin);
-  bool newFlag50 = isTouchedStable(sensor50Pin, sensorCommonPin);
-  bool newFlag80 = isTouchedStable(sensor80Pin, sensorCommonPin);
+  // Sensoren nacheinander mit der konfigurierten Anzahl Messungen (cfg().voteSamples) abfragen
+  bool newFlag10 = isTouchedStable(cfg().pinSensor10, cfg().pinCommon);
+  bool newFlag50 = isTouchedStable(cfg().pinSensor50, cfg().pinCommon);
+  bool newFlag80 = isTouchedStable(cfg().pinSensor80, cfg().pinCommon);
 
   // Hysterese für 10%
   if (newFlag10 == flag10) {
     stable10 = 0;
   } else {
     stable10++;
-    if (stable10 >= stableLimit) {
+    if (stable10 >= cfg().stableLimit) {
       flag10 = newFlag10;
       stable10 = 0;
+      bumpStateGeneration();
     }
   }
   // Hysterese für 50%
@@ -207,9 +486,10 @@ void checkAllWaterLevels() {
     stable50 = 0;
   } else {
     stable50++;
-    if (stable50 >= stableLimit) {
+    if (stable50 >= cfg().stableLimit) {
       flag50 = newFlag50;
       stable50 = 0;
+      bumpStateGeneration();
     }
   }
   // Hysterese für 80%
@@ -217,9 +497,10 @@ void checkAllWaterLevels() {
     stable80 = 0;
   } else {
     stable80++;
-    if (stable80 >= stableLimit) {
+    if (stable80 >= cfg().stableLimit) {
       flag80 = newFlag80;
       stable80 = 0;
+      bumpStateGeneration();
     }
   }
 
@@ -237,18 +518,18 @@ void checkAllWaterLevels() {
 
   // Loggen der Pumpenzyklen
   // Intervall anpassen, wenn 80%-Flag aktiv wird
-  if (flag80 && sensorCheckInterval != sensorCheckIntervalFast) {
-    sensorCheckInterval = sensorCheckIntervalFast;
-    Serial.println("80%-Flag erkannt, Sensor-Check-Intervall auf 1s gesetzt.");
-  } else if (!flag80 && sensorCheckInterval != sensorCheckIntervalDefault) {
-    sensorCheckInterval = sensorCheckIntervalDefault;
-    Serial.println("Sensor-Check-Intervall zurück auf 3s gesetzt.");
+  if (flag80 && sensorCheckInterval != cfg().intervalFast) {
+    sensorCheckInterval = cfg().intervalFast;
+    Serial.printf("80%%-Flag erkannt, Sensor-Check-Intervall auf %lu ms gesetzt.\n", sensorCheckInterval);
+  } else if (!flag80 && sensorCheckInterval != cfg().intervalDefault) {
+    sensorCheckInterval = cfg().intervalDefault;
+    Serial.printf("Sensor-Check-Intervall zurück auf %lu ms gesetzt.\n", sensorCheckInterval);
   }
 
   // Pumpe starten, wenn 80%-Flag aktiv und Pumpe noch nicht läuft
   if ((flag80 && !isPumping) && (flag50 || flag10)) {
     isPumping = true;
-    digitalWrite(pumpPin, HIGH);
+    digitalWrite(cfg().pinPump, HIGH);
     Serial.println("Pumpe gestartet (80% erreicht)");
     flashLED(4); // 4x blinken beim Pumpenstart
     logMessage("Pumpe gestartet (80% erreicht)"); // Log-Eintrag
@@ -257,7 +538,7 @@ void checkAllWaterLevels() {
   // Pumpe stoppen, wenn 10%-Flag von 1 auf 0 wechselt, 50% und 80% sind 0 und Pumpe läuft
   if (lastFlag10 && !flag10 && isPumping && !flag50 && !flag80) {
     isPumping = false;
-    digitalWrite(pumpPin, LOW);
+    digitalWrite(cfg().pinPump, LOW);
     pumpCycles++;
     logMessage("Pumpe gestoppt (10% unterschritten, 50% und 80% sind 0)"); // Log-Eintrag
     Serial.println("Pumpe gestoppt (10% unterschritten, 50% und 80% sind 0)");
@@ -266,10 +547,11 @@ void checkAllWaterLevels() {
     flashLED(4); // 4x blinken beim Pumpenstopp
 
     // Nach Erreichen von 10% nur noch alle 60 Sekunden messen, wenn DEBUG nicht aktiviert
-    if (!DEBUG_MODE){
-    sensorCheckInterval = sensorCheckIntervalLong;
-    Serial.println("10%-Flag gefallen, Sensor-Check-Intervall auf 60s gesetzt.");
-    logMessage("10%-Flag gefallen, Sensor-Check-Intervall auf 60s gesetzt."); // Log-Eintrag
+    if (!cfg().debugMode){
+    sensorCheckInterval = cfg().intervalLong;
+    String msg = "10%-Flag gefallen, Sensor-Check-Intervall auf " + String(sensorCheckInterval / 1000) + "s gesetzt.";
+    Serial.println(msg);
+    logMessage(msg); // Log-Eintrag
     }
   }
 
@@ -288,59 +570,214 @@ void updateLED(unsigned long now) {
     // Status-LED blinkt
     if (now - lastLedToggle > 500) {
       ledState = !ledState;
-      digitalWrite(ledPin, ledState ? LOW : HIGH); // LOW = AN, HIGH = AUS
+      digitalWrite(cfg().pinLed, ledState ? LOW : HIGH); // LOW = AN, HIGH = AUS
       lastLedToggle = now;
     }
     digitalWrite(LED_BUILTIN, LOW); // BUILTIN_LED AN
   }
   else if (flag50) {
-    digitalWrite(ledPin, LOW);      // LED AN bei 50%
+    digitalWrite(cfg().pinLed, LOW);      // LED AN bei 50%
     digitalWrite(LED_BUILTIN, HIGH); // BUILTIN_LED AUS
   }
   else {
-    digitalWrite(ledPin, HIGH);     // LED AUS
+    digitalWrite(cfg().pinLed, HIGH);     // LED AUS
     digitalWrite(LED_BUILTIN, HIGH); // BUILTIN_LED AUS
   }
 }
 
 void flashLED(int times) {
   for (int i = 0; i < times; i++) {
-    digitalWrite(ledPin, LOW);   // LED AN
+    digitalWrite(cfg().pinLed, LOW);   // LED AN
     delay(80);
-    digitalWrite(ledPin, HIGH);  // LED AUS
+    digitalWrite(cfg().pinLed, HIGH);  // LED AUS
     delay(80);
   }
 }
 
-void handleRoot() {
+// Rendert die Statusseite in den Cache. Gibt false zurück, wenn die Vorlage fehlt.
+bool renderStatusPage() {
   File file = LittleFS.open("/status_page.html", "r");
-  if (file) {
-    String html = file.readString();
-    html.replace("%80CLS%", flag80 ? "green" : "red");
-    html.replace("%50CLS%", flag50 ? "green" : "red");
-    html.replace("%10CLS%", flag10 ? "green" : "red");
-    html.replace("%PUMPCLS%", isPumping ? "blue" : "red");
-    html.replace("%PUMPCYCLES%", String(pumpCycles));
-    html.replace("%PUMPBTNCLS%", isPumping ? "btn-success" : "btn-secondary");
-    html.replace("%PUMPTXT%", isPumping ? "AN" : "AUS");
-    html.replace("%LOG%", getLogHtml());
-
-    // Dynamischer Statusbereich
-    String statusHtml = "<div id='statusArea'>";
-    statusHtml += "Füllstand Flags: 80%:" + String(flag80 ? "1 " : "0 ") +
-                  "50%:" + String(flag50 ? "1 " : "0 ") +
-                  "10%:" + String(flag10 ? "1" : "0 ") + "<br>";
-    statusHtml += "Pumpe " + String(isPumping ? "AN" : "AUS") + "<br>";
-    statusHtml += "Gesamtstarts: " + String(pumpCycles);
-    statusHtml += "</div>";
-
-    html.replace("%STATUSHTML%", statusHtml);
-
-    server.send(200, "text/html", html);
-    file.close();
-  } else {
+  if (!file) return false;
+
+  // Vorlage direkt in den reservierten Puffer lesen (kein neuer Heap-Block pro Rendern)
+  pageCache = "";
+  char buf[256];
+  while (file.available()) {
+    size_t n = file.readBytes(buf, sizeof(buf));
+    if (n == 0) break;
+    pageCache.concat(buf, n);
+  }
+  file.close();
+
+  pageCache.replace("%80CLS%", flag80 ? "green" : "red");
+  pageCache.replace("%50CLS%", flag50 ? "green" : "red");
+  pageCache.replace("%10CLS%", flag10 ? "green" : "red");
+  pageCache.replace("%PUMPCLS%", isPumping ? "blue" : "red");
+  pageCache.replace("%PUMPCYCLES%", String(pumpCycles));
+  pageCache.replace("%PUMPBTNCLS%", isPumping ? "btn-success" : "btn-secondary");
+  pageCache.replace("%PUMPTXT%", isPumping ? "AN" : "AUS");
+  pageCache.replace("%LOG%", getLogHtml());
+  pageCache.replace("%PUMPMS%", String(cfg().manualPumpMs));
+
+  // Dynamischer Statusbereich
+  String statusHtml = "<div id='statusArea'>";
+  statusHtml += "Füllstand Flags: 80%:" + String(flag80 ? "1 " : "0 ") +
+                "50%:" + String(flag50 ? "1 " : "0 ") +
+                "10%:" + String(flag10 ? "1" : "0 ") + "<br>";
+  statusHtml += "Pumpe " + String(isPumping ? "AN" : "AUS") + "<br>";
+  statusHtml += "Gesamtstarts: " + String(pumpCycles);
+  statusHtml += "</div>";
+
+  pageCache.replace("%STATUSHTML%", statusHtml);
+  return true;
+}
+
+void handleRoot() {
+  String etag = "\"" + String(stateGeneration) + "\"";
+
+  // Browser hat den aktuellen Stand bereits -> 304 ohne Body
+  if (server.header("If-None-Match") == etag) {
+    server.sendHeader("ETag", etag);
+    server.sendHeader("Cache-Control", "no-cache");
+    server.send(304);
+    return;
+  }
+
+  // Nur neu rendern, wenn sich der Zustand seit dem letzten Rendern geändert hat
+  if (!pageCacheValid || pageCacheGen != stateGeneration) {
+    if (!renderStatusPage()) {
+      pageCacheValid = false;
+      server.send(404, "text/plain", "File not found");
+      return;
+    }
+    pageCacheGen = stateGeneration;
+    pageCacheValid = true;
+  }
+
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Cache-Control", "no-cache");
+  server.send(200, "text/html", pageCache);
+}
+
+// <option>-Liste für die Pin-Auswahl im Konfigurationsformular
+String pinOptionsHtml(uint8_t selected) {
+  String html;
+  for (int i = 0; i < CONFIG_PIN_COUNT; i++) {
+    html += "<option value='" + String(CONFIG_PINS[i]) + "'";
+    if (CONFIG_PINS[i] == selected) html += " selected";
+    html += ">" + String(CONFIG_PIN_NAMES[i]) + "</option>";
+  }
+  return html;
+}
+
+void handleConfigGet() {
+  File file = LittleFS.open("/config_page.html", "r");
+  if (!file) {
     server.send(404, "text/plain", "File not found");
+    return;
+  }
+  String html = file.readString();
+  file.close();
+
+  const RuntimeConfig& c = cfg();
+  html.replace("%MSG%", server.hasArg("saved") ? "<div class='alert alert-success'>Gespeichert und aktiv</div>" : "");
+  html.replace("%DEBUG1%", c.debugMode ? "selected" : "");
+  html.replace("%DEBUG0%", c.debugMode ? "" : "selected");
+  html.replace("%INTDEFAULT%", String(c.intervalDefault));
+  html.replace("%INTFAST%", String(c.intervalFast));
+  html.replace("%INTLONG%", String(c.intervalLong));
+  html.replace("%STABLE%", String(c.stableLimit));
+  html.replace("%SAMPLES%", String(c.voteSamples));
+  html.replace("%HITS%", String(c.voteHits));
+  html.replace("%SPACING%", String(c.voteSpacingMs));
+  html.replace("%PUMPMS%", String(c.manualPumpMs));
+  html.replace("%PIN10%", pinOptionsHtml(c.pinSensor10));
+  html.replace("%PIN50%", pinOptionsHtml(c.pinSensor50));
+  html.replace("%PIN80%", pinOptionsHtml(c.pinSensor80));
+  html.replace("%PINLED%", pinOptionsHtml(c.pinLed));
+  html.replace("%PINCOMMON%", pinOptionsHtml(c.pinCommon));
+  html.replace("%PINPUMP%", pinOptionsHtml(c.pinPump));
+  html.replace("%LOADUS%", String(configLoadMicros));
+
+  server.send(200, "text/html", html);
+}
+
+// Liest ein numerisches Formularfeld. Fehlt es, bleibt der bisherige Wert stehen.
+bool readConfigArg(const char* name, uint32_t maxValue, uint32_t& value, String& error) {
+  if (!server.hasArg(name)) return true;
+  String arg = server.arg(name);
+  arg.trim();
+  if (arg.length() == 0) return true;
+  for (unsigned int i = 0; i < arg.length(); i++) {
+    if (!isDigit(arg[i])) {
+      error = String(name) + ": keine Zahl";
+      return false;
+    }
+  }
+  if (arg.length() > 10 || strtoul(arg.c_str(), nullptr, 10) > maxValue) {
+    error = String(name) + ": zu groß";
+    return false;
+  }
+  value = strtoul(arg.c_str(), nullptr, 10);
+  return true;
+}
+
+void handleConfigPost() {
+  RuntimeConfig candidate = cfg();
+  String error;
+
+  uint32_t intervalDefault = candidate.intervalDefault, intervalFast = candidate.intervalFast,
+           intervalLong = candidate.intervalLong, manualPumpMs = candidate.manualPumpMs,
+           voteSpacingMs = candidate.voteSpacingMs, voteSamples = candidate.voteSamples,
+           voteHits = candidate.voteHits, stableLimit = candidate.stableLimit,
+           debugMode = candidate.debugMode, pin10 = candidate.pinSensor10,
+           pin50 = candidate.pinSensor50, pin80 = candidate.pinSensor80, pinLed = candidate.pinLed,
+           pinCommon = candidate.pinCommon, pinPump = candidate.pinPump;
+
+  bool ok = readConfigArg("debug", 0xFF, debugMode, error) &&
+            readConfigArg("intervalDefault", 0xFFFFFFFF, intervalDefault, error) &&
+            readConfigArg("intervalFast", 0xFFFFFFFF, intervalFast, error) &&
+            readConfigArg("intervalLong", 0xFFFFFFFF, intervalLong, error) &&
+            readConfigArg("stableLimit", 0xFF, stableLimit, error) &&
+            readConfigArg("voteSamples", 0xFF, voteSamples, error) &&
+            readConfigArg("voteHits", 0xFF, voteHits, error) &&
+            readConfigArg("voteSpacing", 0xFFFF, voteSpacingMs, error) &&
+            readConfigArg("manualPumpMs", 0xFFFFFFFF, manualPumpMs, error) &&
+            readConfigArg("pin10", 0xFF, pin10, error) &&
+            readConfigArg("pin50", 0xFF, pin50, error) &&
+            readConfigArg("pin80", 0xFF, pin80, error) &&
+            readConfigArg("pinLed", 0xFF, pinLed, error) &&
+            readConfigArg("pinCommon", 0xFF, pinCommon, error) &&
+            readConfigArg("pinPump", 0xFF, pinPump, error);
+  if (!ok) {
+    server.send(400, "text/plain", "Fehler: " + error);
+    return;
   }
+
+  candidate.intervalDefault = intervalDefault;
+  candidate.intervalFast = intervalFast;
+  candidate.intervalLong = intervalLong;
+  candidate.manualPumpMs = manualPumpMs;
+  candidate.voteSpacingMs = voteSpacingMs;
+  candidate.voteSamples = voteSamples;
+  candidate.voteHits = voteHits;
+  candidate.stableLimit = stableLimit;
+  candidate.debugMode = debugMode;
+  candidate.pinSensor10 = pin10;
+  candidate.pinSensor50 = pin50;
+  candidate.pinSensor80 = pin80;
+  candidate.pinLed = pinLed;
+  candidate.pinCommon = pinCommon;
+  candidate.pinPump = pinPump;
+
+  if (!updateConfig(candidate, error)) {
+    server.send(400, "text/plain", "Fehler: " + error);
+    return;
+  }
+  logMessage("Konfiguration geändert und aktiviert");
+
+  server.sendHeader("Location", "/config?saved=1");
+  server.send(303);
 }
 
 void loop() {
@@ -360,15 +797,15 @@ void loop() {
   server.handleClient();
 
   if (manualPumpActive && millis() > manualPumpOffTime) {
-    digitalWrite(pumpPin, LOW);
+    digitalWrite(cfg().pinPump, LOW);
     isPumping = false;
     manualPumpActive = false;
-    logMessage("Pumpe nach 10 Sekunden automatisch gestoppt");
+    logMessage("Pumpe nach " + String(manualPumpRunMs / 1000.0, 1) + " Sekunden automatisch gestoppt");
   }
 }
 
 void setSensorCheckInterval(unsigned long newInterval) {
-  if (!DEBUG_MODE) {
+  if (!cfg().debugMode) {
     sensorCheckInterval = newInterval;
     Serial.printf("Messintervall geändert auf %lu ms\n", newInterval);
   } else {